@@ -38,7 +38,7 @@ int main(int argc, char* argv[])
         }
 
         sgm::SimpleImage DMap;
-        if (utils::instructionset::avx2_supported())
+        if (sgm::instructionset::avx2_supported())
         {
             utils::perf::PerformanceTimer timer("AVX2 accelerated sgm");
             sgm::SemiGlobalMatching<DMax, DMin, true> Sgm(std::move(LeftImage), std::move(RightImage));
@@ -15,43 +15,6 @@
 
 namespace utils
 {
-namespace instructionset
-{
-void run_cpuid(int eax, int ecx, int* cpuInfo)
-{
-#if defined(_MSC_VER)
-    __cpuidex(cpuInfo, eax, ecx);
-
-#else
-    int ebx = 0;
-    int edx = 0;
-
-#if defined(__i386__) && defined(__PIC__)
-
-    /* in case of PIC under 32-bit EBX cannot be clobbered */
-    __asm__("movl %%ebx, %%edi \n\t cpuid \n\t xchgl %%ebx, %%edi"
-            : "=D"(ebx),
-#else
-    __asm__("cpuid"
-            : "+b"(ebx),
-#endif
-              "+a"(eax), "+c"(ecx), "=d"(edx));
-    cpuInfo[0] = eax;
-    cpuInfo[1] = ebx;
-    cpuInfo[2] = ecx;
-    cpuInfo[3] = edx;
-#endif
-}
-
-bool avx2_supported()
-{
-    const int AVX_2_SUPPORTED = (1 << 5) | (1 << 3) | (1 << 8);
-    int abcd[4];
-    run_cpuid(7, 0, abcd);
-    return (abcd[1] & AVX_2_SUPPORTED) == AVX_2_SUPPORTED;
-}
-}  // namespace instructionset
-
 namespace io
 {
 sgm::SimpleImage readImage(std::string filename)
@@ -0,0 +1,221 @@
+"""
+Python bindings of libsgm, the precompiled SemiGlobal Matching kernels.
+
+Images are passed to the library as pointers to the NumPy buffers, without any copy, and the GIL is released while
+the disparity is computed, so that several threads can run their own Engine concurrently.
+"""
+
+import ctypes
+import ctypes.util
+import os
+import sys
+import threading
+
+import numpy as np
+
+__all__ = ["SgmError", "Engine", "compute_disparity", "is_range_supported", "avx2_enabled"]
+
+_SGM_OK = 0
+
+
+def _library_candidates():
+    override = os.environ.get("SGM_LIBRARY")
+    if override:
+        yield override
+
+    if sys.platform == "win32":
+        names = ["sgm.dll"]
+    elif sys.platform == "darwin":
+        names = ["libsgm.dylib"]
+    else:
+        names = ["libsgm.so"]
+
+    here = os.path.dirname(os.path.abspath(__file__))
+    # next to the package, then the install layout <prefix>/<libdir>/python/sgm and <prefix>/bin for dlls
+    for directory in (here, os.path.join(here, "..", ".."), os.path.join(here, "..", "..", "..", "bin")):
+        for name in names:
+            yield os.path.normpath(os.path.join(directory, name))
+
+    found = ctypes.util.find_library("sgm")
+    if found:
+        yield found
+
+
+def _load_library():
+    for candidate in _library_candidates():
+        try:
+            return ctypes.CDLL(candidate)
+        except OSError:
+            continue
+
+    raise ImportError("libsgm could not be found, set SGM_LIBRARY to the path of the shared library")
+
+
+_lib = _load_library()
+
+_lib.sgm_status_string.argtypes = [ctypes.c_int]
+_lib.sgm_status_string.restype = ctypes.c_char_p
+
+_lib.sgm_is_range_supported.argtypes = [ctypes.c_size_t, ctypes.c_size_t]
+_lib.sgm_is_range_supported.restype = ctypes.c_int
+
+_lib.sgm_avx2_enabled.argtypes = []
+_lib.sgm_avx2_enabled.restype = ctypes.c_int
+
+_lib.sgm_engine_create.argtypes = [
+    ctypes.c_size_t,
+    ctypes.c_size_t,
+    ctypes.c_size_t,
+    ctypes.c_size_t,
+    ctypes.POINTER(ctypes.c_void_p),
+]
+_lib.sgm_engine_create.restype = ctypes.c_int
+
+_lib.sgm_engine_destroy.argtypes = [ctypes.c_void_p]
+_lib.sgm_engine_destroy.restype = None
+
+_lib.sgm_engine_set_penalties.argtypes = [ctypes.c_void_p, ctypes.c_uint16, ctypes.c_uint16]
+_lib.sgm_engine_set_penalties.restype = ctypes.c_int
+
+_lib.sgm_engine_process.argtypes = [
+    ctypes.c_void_p,
+    ctypes.c_void_p,
+    ctypes.c_size_t,
+    ctypes.c_void_p,
+    ctypes.c_size_t,
+    ctypes.c_void_p,
+    ctypes.c_size_t,
+]
+_lib.sgm_engine_process.restype = ctypes.c_int
+
+
+class SgmError(RuntimeError):
+    def __init__(self, status):
+        super().__init__(_lib.sgm_status_string(status).decode())
+        self.status = status
+
+
+def _check(status):
+    if status != _SGM_OK:
+        raise SgmError(status)
+
+
+def is_range_supported(dmin, dmax):
+    return bool(_lib.sgm_is_range_supported(dmin, dmax))
+
+
+def avx2_enabled():
+    return bool(_lib.sgm_avx2_enabled())
+
+
+def _row_stride(array, name, dtype, shape, writeable=False):
+    """Returns the row stride, in elements, of an array that can be handed over to libsgm without copy"""
+    if not isinstance(array, np.ndarray) or array.dtype != dtype:
+        raise TypeError("{} must be a numpy array of {}".format(name, np.dtype(dtype).name))
+
+    if array.shape != shape:
+        raise ValueError("{} must have shape {}, got {}".format(name, shape, array.shape))
+
+    itemsize = array.itemsize
+    # the column stride is meaningless for single column views
+    columns_contiguous = shape[1] == 1 or array.strides[1] == itemsize
+    if not columns_contiguous or array.strides[0] % itemsize != 0 or array.strides[0] < shape[1] * itemsize:
+        raise ValueError("{} rows must be contiguous, use numpy.ascontiguousarray".format(name))
+
+    # libsgm dereferences the buffers as arrays of their element type
+    if not array.flags.aligned:
+        raise ValueError("{} must be aligned on its element size, use numpy.ascontiguousarray".format(name))
+
+    if writeable and not array.flags.writeable:
+        raise ValueError("{} must be writeable".format(name))
+
+    return array.strides[0] // itemsize
+
+
+class Engine:
+    """
+    Computes disparity maps of 8 bit grayscale image pairs of a fixed size, reusing its working buffers.
+
+    Each call to compute is serialized on the engine; use one engine per thread to compute in parallel.
+    """
+
+    def __init__(self, width, height, *, dmin=0, dmax=64, p1=None, p2=None):
+        self._handle = ctypes.c_void_p()
+        self._lock = threading.Lock()
+        _check(_lib.sgm_engine_create(width, height, dmin, dmax, ctypes.byref(self._handle)))
+
+        self.width = width
+        self.height = height
+        self.dmin = dmin
+        self.dmax = dmax
+
+        if p1 is not None or p2 is not None:
+            if p1 is None or p2 is None:
+                raise ValueError("p1 and p2 must be given together")
+            self.set_penalties(p1, p2)
+
+    def set_penalties(self, p1, p2):
+        # ctypes would silently wrap values that do not fit in uint16_t
+        for name, value in (("p1", p1), ("p2", p2)):
+            if not 0 <= value <= 0xFFFF:
+                raise ValueError("{} must be in [0, 65535], got {}".format(name, value))
+
+        with self._lock:
+            _check(_lib.sgm_engine_set_penalties(self._get_handle(), p1, p2))
+
+    def compute(self, left, right, out=None):
+        """
+        Returns the disparity of each pixel of left, in the range [dmin, dmax), as a uint16 array.
+        If given, out receives the disparity map and is returned.
+        """
+        shape = (self.height, self.width)
+        left_stride = _row_stride(left, "left", np.uint8, shape)
+        right_stride = _row_stride(right, "right", np.uint8, shape)
+
+        if out is None:
+            out = np.empty(shape, dtype=np.uint16)
+        out_stride = _row_stride(out, "out", np.uint16, shape, writeable=True)
+
+        # ctypes releases the GIL for the duration of the call
+        with self._lock:
+            _check(
+                _lib.sgm_engine_process(
+                    self._get_handle(),
+                    left.ctypes.data,
+                    left_stride,
+                    right.ctypes.data,
+                    right_stride,
+                    out.ctypes.data,
+                    out_stride,
+                )
+            )
+
+        return out
+
+    def close(self):
+        with self._lock:
+            if self._handle:
+                _lib.sgm_engine_destroy(self._handle)
+                self._handle = ctypes.c_void_p()
+
+    def _get_handle(self):
+        if not self._handle:
+            raise ValueError("the engine has been closed")
+        return self._handle
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        if getattr(self, "_handle", None):
+            _lib.sgm_engine_destroy(self._handle)
+
+
+def compute_disparity(left, right, *, dmin=0, dmax=64, p1=10, p2=80):
+    """Computes the disparity map of a single image pair, see Engine to process several pairs"""
+    height, width = np.shape(left)
+    with Engine(width, height, dmin=dmin, dmax=dmax, p1=p1, p2=p2) as engine:
+        return engine.compute(left, right)
@@ -0,0 +1,123 @@
+import ctypes
+import threading
+import unittest
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+if np is not None:
+    import sgm
+
+WIDTH = 300
+HEIGHT = 120
+
+
+def make_stereo_pair():
+    """Same synthetic pair as simple-sgm/tests/test_utils.h"""
+    state = 1
+    right = bytearray(WIDTH * HEIGHT)
+    for i in range(WIDTH * HEIGHT):
+        state = (state * 1103515245 + 12345) & 0xFFFFFFFF
+        right[i] = (state >> 16) & 0xFF
+
+    left = bytearray(WIDTH * HEIGHT)
+    for iy in range(HEIGHT):
+        for ix in range(WIDTH):
+            shift = 7 if ix < WIDTH // 2 else 21
+            left[ix + WIDTH * iy] = right[ix - shift + WIDTH * iy] if ix >= shift else 0
+
+    return bytes(left), bytes(right)
+
+
+def process_with_c_api(left, right):
+    """Runs the C interface directly on plain buffers, without going through numpy"""
+    lib = sgm._lib
+    engine = ctypes.c_void_p()
+    assert lib.sgm_engine_create(WIDTH, HEIGHT, 0, 64, ctypes.byref(engine)) == 0
+    try:
+        assert lib.sgm_engine_set_penalties(engine, 10, 80) == 0
+        disparity = (ctypes.c_uint16 * (WIDTH * HEIGHT))()
+        left_buffer = ctypes.create_string_buffer(left, len(left))
+        right_buffer = ctypes.create_string_buffer(right, len(right))
+        assert lib.sgm_engine_process(engine, left_buffer, WIDTH, right_buffer, WIDTH, disparity, WIDTH) == 0
+        return list(disparity)
+    finally:
+        lib.sgm_engine_destroy(engine)
+
+
+@unittest.skipIf(np is None, "numpy is not available")
+class EngineTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        left, right = make_stereo_pair()
+        cls.expected = process_with_c_api(left, right)
+        cls.left = np.frombuffer(left, dtype=np.uint8).reshape(HEIGHT, WIDTH)
+        cls.right = np.frombuffer(right, dtype=np.uint8).reshape(HEIGHT, WIDTH)
+
+    def test_compute_matches_c_api(self):
+        with sgm.Engine(WIDTH, HEIGHT, dmin=0, dmax=64, p1=10, p2=80) as engine:
+            disparity = engine.compute(self.left, self.right)
+
+        self.assertEqual(disparity.dtype, np.uint16)
+        self.assertEqual(disparity.shape, (HEIGHT, WIDTH))
+        self.assertEqual(disparity.ravel().tolist(), self.expected)
+
+    def test_compute_strided_views(self):
+        padded_left = np.zeros((HEIGHT, WIDTH + 16), dtype=np.uint8)
+        padded_right = np.zeros((HEIGHT, WIDTH + 16), dtype=np.uint8)
+        padded_left[:, :WIDTH] = self.left
+        padded_right[:, :WIDTH] = self.right
+        out = np.full((HEIGHT, WIDTH + 8), 0xFFFF, dtype=np.uint16)
+
+        with sgm.Engine(WIDTH, HEIGHT, dmax=64, p1=10, p2=80) as engine:
+            disparity = engine.compute(padded_left[:, :WIDTH], padded_right[:, :WIDTH], out=out[:, :WIDTH])
+
+        self.assertTrue(np.shares_memory(disparity, out))
+        self.assertEqual(disparity.ravel().tolist(), self.expected)
+        self.assertTrue(np.all(out[:, WIDTH:] == 0xFFFF))
+
+    def test_threads_with_their_own_engine(self):
+        results = [None] * 2
+
+        def run(index):
+            with sgm.Engine(WIDTH, HEIGHT, dmax=64, p1=10, p2=80) as engine:
+                results[index] = engine.compute(self.left, self.right)
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(len(results))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        for result in results:
+            self.assertIsNotNone(result)
+            self.assertEqual(result.ravel().tolist(), self.expected)
+
+    def test_invalid_arguments(self):
+        with self.assertRaises(sgm.SgmError):
+            sgm.Engine(WIDTH, HEIGHT, dmin=16, dmax=64)
+
+        with self.assertRaises(sgm.SgmError):
+            sgm.Engine(1 << 62, 8, dmax=16)
+
+        for p1, p2 in ((-1, 80), (70000, 80), (10, -1), (10, 1 << 16)):
+            with self.assertRaises(ValueError):
+                sgm.Engine(WIDTH, HEIGHT, dmax=64, p1=p1, p2=p2)
+
+        with sgm.Engine(WIDTH, HEIGHT, dmax=64) as engine:
+            with self.assertRaises(ValueError):
+                engine.set_penalties(-1, 80)
+            with self.assertRaises(ValueError):
+                engine.compute(self.left[:, ::2], self.right[:, ::2])
+            with self.assertRaises(TypeError):
+                engine.compute(self.left.astype(np.uint16), self.right)
+
+            unaligned = np.zeros(HEIGHT * WIDTH * 2 + 1, dtype=np.uint8)[1:].view(np.uint16).reshape(HEIGHT, WIDTH)
+            with self.assertRaises(ValueError):
+                engine.compute(self.left, self.right, out=unaligned)
+
+
+if __name__ == "__main__":
+    unittest.main()
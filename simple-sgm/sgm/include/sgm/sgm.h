@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
 #include <sgm/sgm_utils.h>
 
 namespace sgm
@@ -67,28 +70,35 @@ class SemiGlobalMatching
         __avx2_dispatch inline static void EvaluateMinAVX2(T* Lmin, __m256i& GlobalMin, T* Lp, __m256i& P1) noexcept
         {
             auto _Lp = _mm256_load_si256(reinterpret_cast<__m256i*>(Lp));
-            auto _Lp_plus = _mm256_lddqu_si256(reinterpret_cast<__m256i*>(Lp + 1));
-
-            GlobalMin = _mm256_min_epu16(GlobalMin, _Lp);
 
+            // the first and last blocks must not read outside of the path vector: shift Lp by one element
+            // in registers and saturate the lane without neighbour, so that it never wins the minimum
+            __m256i _Lp_minus;
             if (0 == cnt)
             {
-                auto _min = _mm256_min_epu16(_Lp, _mm256_adds_epu16(_Lp_plus, P1));
-                _mm256_store_si256(reinterpret_cast<__m256i*>(Lmin), _min);
-                Loop<cnt + 1, N>::EvaluateMinAVX2(Lmin + 16, GlobalMin, Lp + 16, P1);
-                return;
+                auto _Lp_shifted = _mm256_alignr_epi8(_Lp, _mm256_permute2x128_si256(_Lp, _Lp, 0x08), 14);
+                auto _FirstLane = _mm256_setr_epi16(-1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+                _Lp_minus = _mm256_or_si256(_Lp_shifted, _FirstLane);
+            }
+            else
+            {
+                _Lp_minus = _mm256_lddqu_si256(reinterpret_cast<__m256i*>(Lp - 1));
             }
 
-            auto _Lp_minus = _mm256_lddqu_si256(reinterpret_cast<__m256i*>(Lp - 1));
-
-            if (N - 16 == cnt)
+            __m256i _Lp_plus;
+            if (N - 1 == cnt)
             {
-                auto _min = _mm256_min_epu16(_Lp, _mm256_adds_epu16(_Lp_minus, P1));
-                _mm256_store_si256(reinterpret_cast<__m256i*>(Lmin), _min);
-                Loop<cnt + 1, N>::EvaluateMinAVX2(Lmin + 16, GlobalMin, Lp + 16, P1);
-                return;
+                auto _Lp_shifted = _mm256_alignr_epi8(_mm256_permute2x128_si256(_Lp, _Lp, 0x81), _Lp, 2);
+                auto _LastLane = _mm256_setr_epi16(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1);
+                _Lp_plus = _mm256_or_si256(_Lp_shifted, _LastLane);
+            }
+            else
+            {
+                _Lp_plus = _mm256_lddqu_si256(reinterpret_cast<__m256i*>(Lp + 1));
             }
 
+            GlobalMin = _mm256_min_epu16(GlobalMin, _Lp);
+
             auto _min = _mm256_min_epu16(_Lp, _mm256_adds_epu16(_mm256_min_epu16(_Lp_minus, _Lp_plus), P1));
             _mm256_store_si256(reinterpret_cast<__m256i*>(Lmin), _min);
             Loop<cnt + 1, N>::EvaluateMinAVX2(Lmin + 16, GlobalMin, Lp + 16, P1);
@@ -133,11 +143,26 @@ class SemiGlobalMatching
 
 public:
     SemiGlobalMatching(SimpleImage&& _Left, SimpleImage&& _Right)
-          : Left(std::move(_Left))
-          , Right(std::move(_Right))
+          : SemiGlobalMatching(_Left.Width, _Left.Height)
     {
-        Width = Left.Width;
-        Height = Left.Height;
+        Left = std::move(_Left);
+        Right = std::move(_Right);
+        ComputeCost();
+    }
+
+    /*
+      Allocates the working buffers for images of the given size without binding any image;
+      the instance can then be reused for several image pairs through ComputeDisparity.
+    */
+    SemiGlobalMatching(size_t _Width, size_t _Height)
+          : Width(_Width)
+          , Height(_Height)
+    {
+        // the cost computation assumes that every row spans the whole disparity range
+        if (Width < DMax || 0 == Height || Width > std::numeric_limits<size_t>::max() / Height / DInt / sizeof(T))
+        {
+            throw std::invalid_argument("Invalid image size");
+        }
 
         C = make_unique_aligned<T, Alignment>(Width * Height * DInt);
         S = make_unique_aligned<T, Alignment>(Width * Height * DInt);
@@ -146,7 +171,6 @@ public:
         PathStorage[2] = make_unique_aligned<T, Alignment>(Width * DInt);
         PathStorage[3] = make_unique_aligned<T, Alignment>(Width * DInt);
         min_Lp_r = make_unique_aligned<T, Alignment>(DInt);
-        ComputeCost();
     }
 
     inline void SetPenalities(T P1, T P2)
@@ -156,9 +180,21 @@ public:
     }
 
     inline void ComputeCost()
+    {
+        ComputeCost(Left.Buffer.get(), Width, Right.Buffer.get(), Width);
+    }
+
+    /*
+      Computes the matching cost from 8 bit images of size Width x Height, whose rows are
+      LeftStride and RightStride bytes apart.
+    */
+    inline void ComputeCost(const uint8_t* pLeft, size_t LeftStride, const uint8_t* pRight, size_t RightStride)
     {
         for (auto iy = 0; iy < Height; iy++)
         {
+            auto pLeftRow = pLeft + LeftStride * iy;
+            auto pRightRow = pRight + RightStride * iy;
+
             for (auto ix = 0; ix < DMin; ix++)
             {
                 auto iidx = ix + Width * iy;
@@ -178,9 +214,9 @@ public:
                 for (auto d = DMin; d < ix; d++)
                 {
                     auto idx = d - DMin + iidx * DInt;
-                    C[idx] = abs(static_cast<short>(Left.Buffer[iidx]) - static_cast<short>(Right.Buffer[iidx - d]));
+                    C[idx] = abs(static_cast<short>(pLeftRow[ix]) - static_cast<short>(pRightRow[ix - d]));
                     assert(idx >= 0 && idx < Width * Height * DInt);
-                    assert(iidx - d >= 0 && iidx - d < Width * Height);
+                    assert(ix - d >= 0 && ix - d < Width);
                 }
 
                 for (auto d = ix; d < DMax; d++)
@@ -198,10 +234,9 @@ public:
                 for (auto d = 0; d < DInt; d++)
                 {
                     auto idx = d + iidx * DInt;
-                    C[idx] =
-                        abs(static_cast<short>(Left.Buffer[iidx]) - static_cast<short>(Right.Buffer[iidx - d - DMin]));
+                    C[idx] = abs(static_cast<short>(pLeftRow[ix]) - static_cast<short>(pRightRow[ix - d - DMin]));
                     assert(idx >= 0 && idx < Width * Height * DInt);
-                    assert(iidx - d - DMin >= 0 && iidx - d - DMin < Width * Height);
+                    assert(ix - d - DMin >= 0 && ix - d - DMin < Width);
                 }
             }
         }
@@ -209,36 +244,67 @@ public:
 
     SimpleImage GetDisparity()
     {
-        ForwardPass<UseAVX2>();
-        BackwardPass<UseAVX2>();
-
         auto Disparity = make_unique_aligned<T>(Width * Height);
         auto Output = make_unique_aligned<uint8_t>(Width * Height);
 
+        ComputeDisparity(Disparity.get(), Width);
+
         T MaxDisparity = DMin;
         T MinDisparity = DMax;
 
         for (auto i = 0; i < Height * Width; i++)
         {
-            auto MinVal = std::numeric_limits<T>::max();
-            auto d = Loop<0, DInt>::GetMinIdx(MinVal, S.get() + i * DInt, 0);
-
-            if (d > MaxDisparity)
-                MaxDisparity = d;
-            if (d < MinDisparity)
-                MinDisparity = d;
-
-            Disparity[i] = d;
+            if (Disparity[i] > MaxDisparity)
+                MaxDisparity = Disparity[i];
+            if (Disparity[i] < MinDisparity)
+                MinDisparity = Disparity[i];
         }
 
+        const auto Range = Max(static_cast<T>(MaxDisparity - MinDisparity), static_cast<T>(1));
+
         for (auto i = 0; i < Height * Width; i++)
         {
-            Output[i] = (Disparity[i] - MinDisparity) * 255 / (MaxDisparity - MinDisparity);
+            Output[i] = (Disparity[i] - MinDisparity) * 255 / Range;
         }
 
         return {std::move(Output), Width, Height};
     }
 
+    /*
+      Aggregates the cost currently stored in C and writes the disparity of each pixel, in the range [DMin, DMax),
+      to pDisparity, whose rows are DisparityStride elements apart.
+    */
+    void ComputeDisparity(T* pDisparity, size_t DisparityStride)
+    {
+        std::memset(S.get(), 0, Width * Height * DInt * sizeof(T));
+
+        ForwardPass<UseAVX2>();
+        BackwardPass<UseAVX2>();
+
+        for (auto iy = 0; iy < Height; iy++)
+        {
+            auto pDisparityRow = pDisparity + DisparityStride * iy;
+
+            for (auto ix = 0; ix < Width; ix++)
+            {
+                auto MinVal = std::numeric_limits<T>::max();
+                auto d = Loop<0, DInt>::GetMinIdx(MinVal, S.get() + (ix + Width * iy) * DInt, 0);
+                pDisparityRow[ix] = static_cast<T>(d + DMin);
+            }
+        }
+    }
+
+    /*
+      Computes the disparity map of a pair of 8 bit images of size Width x Height without taking ownership of
+      any buffer, so that the same instance can process a sequence of image pairs.
+    */
+    void ComputeDisparity(const uint8_t* pLeft, size_t LeftStride, const uint8_t* pRight, size_t RightStride,
+                          T* pDisparity, size_t DisparityStride)
+    {
+        ComputeCost(pLeft, LeftStride, pRight, RightStride);
+        ComputeDisparity(pDisparity, DisparityStride);
+    }
+
 private:
     __avx2_dispatch inline void EvaluateMinAVX2Proxy(T* Lmin, T& GlobalMin, T* Lp, T P1) noexcept
     {
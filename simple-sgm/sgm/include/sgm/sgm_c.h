@@ -0,0 +1,65 @@
+#pragma once
+
+#include <sgm/sgm_export.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  C interface of the precompiled SemiGlobal Matching kernels shipped with libsgm.
+
+  An engine owns the working buffers for a given image size and disparity range, and can be reused for any number
+  of image pairs. Engines are not thread safe: concurrent computations require one engine per thread.
+
+  Kernels are instantiated for DMin = 0 and DMax in {16, 32, 48, 64, 96, 128, 192, 256}; the AVX2 variant is selected
+  at runtime when supported by the cpu.
+*/
+
+typedef struct sgm_engine sgm_engine;
+
+typedef enum sgm_status
+{
+    SGM_OK = 0,
+    SGM_ERROR_INVALID_ARGUMENT = -1,
+    SGM_ERROR_UNSUPPORTED_RANGE = -2,
+    SGM_ERROR_OUT_OF_MEMORY = -3,
+    SGM_ERROR_INTERNAL = -4
+} sgm_status;
+
+/* Returns a static, human readable description of status */
+SGM_EXPORT const char* sgm_status_string(sgm_status status);
+
+/* Returns 1 if a kernel is available for the disparity range [dmin, dmax), 0 otherwise */
+SGM_EXPORT int sgm_is_range_supported(size_t dmin, size_t dmax);
+
+/* Returns 1 if engines created in this process use the AVX2 kernels, 0 otherwise */
+SGM_EXPORT int sgm_avx2_enabled(void);
+
+/*
+  Creates an engine for images of size width x height and disparities in [dmin, dmax).
+  The image width must be at least dmax and the cost volumes of width x height x dmax elements must be
+  addressable. On success *engine must be released with sgm_engine_destroy.
+*/
+SGM_EXPORT sgm_status sgm_engine_create(size_t width, size_t height, size_t dmin, size_t dmax, sgm_engine** engine);
+
+SGM_EXPORT void sgm_engine_destroy(sgm_engine* engine);
+
+/* Sets the penalties for disparity changes of one pixel (p1) and of more than one pixel (p2) */
+SGM_EXPORT sgm_status sgm_engine_set_penalties(sgm_engine* engine, uint16_t p1, uint16_t p2);
+
+/*
+  Computes the disparity map of a pair of 8 bit grayscale images into a caller provided buffer.
+  Strides are the distance between two rows, in bytes for the images and in elements for the disparity map.
+  Each output element receives the disparity of the pixel, in the range [dmin, dmax).
+*/
+SGM_EXPORT sgm_status sgm_engine_process(sgm_engine* engine, const uint8_t* left, size_t left_stride,
+                                         const uint8_t* right, size_t right_stride, uint16_t* disparity,
+                                         size_t disparity_stride);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 #include <memory>
+#include <new>
 #include <type_traits>
 
 #if defined(_MSC_VER)
@@ -14,6 +16,43 @@
 
 namespace sgm
 {
+namespace instructionset
+{
+inline void run_cpuid(int eax, int ecx, int* cpuInfo)
+{
+#if defined(_MSC_VER)
+    __cpuidex(cpuInfo, eax, ecx);
+
+#else
+    int ebx = 0;
+    int edx = 0;
+
+#if defined(__i386__) && defined(__PIC__)
+
+    /* in case of PIC under 32-bit EBX cannot be clobbered */
+    __asm__("movl %%ebx, %%edi \n\t cpuid \n\t xchgl %%ebx, %%edi"
+            : "=D"(ebx),
+#else
+    __asm__("cpuid"
+            : "+b"(ebx),
+#endif
+              "+a"(eax), "+c"(ecx), "=d"(edx));
+    cpuInfo[0] = eax;
+    cpuInfo[1] = ebx;
+    cpuInfo[2] = ecx;
+    cpuInfo[3] = edx;
+#endif
+}
+
+inline bool avx2_supported()
+{
+    const int AVX_2_SUPPORTED = (1 << 5) | (1 << 3) | (1 << 8);
+    int abcd[4];
+    run_cpuid(7, 0, abcd);
+    return (abcd[1] & AVX_2_SUPPORTED) == AVX_2_SUPPORTED;
+}
+}  // namespace instructionset
+
 template <class T>
 struct aligned_deleter
 {
@@ -34,7 +73,7 @@ auto make_unique_aligned(size_t n) -> std::enable_if_t<std::is_arithmetic<T>::va
 
     if (nullptr == p)
     {
-        throw std::runtime_error("Failed to allocate aligned memory");
+        throw std::bad_alloc();
     }
     std::memset(p, 0, n * sizeof(T));
 
@@ -47,6 +86,12 @@ inline T Min(T const& left, T const& right)
     return left < right ? left : right;
 }
 
+template <typename T>
+inline T Max(T const& left, T const& right)
+{
+    return left < right ? right : left;
+}
+
 struct SimpleImage
 {
     unique_ptr_aligned<uint8_t> Buffer;
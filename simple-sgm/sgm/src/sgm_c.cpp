@@ -0,0 +1,218 @@
+#include <sgm/sgm.h>
+#include <sgm/sgm_c.h>
+
+#include <new>
+
+struct sgm_engine
+{
+    const size_t Width;
+    const size_t Height;
+
+    sgm_engine(size_t _Width, size_t _Height)
+          : Width(_Width)
+          , Height(_Height)
+    {
+    }
+
+    virtual ~sgm_engine() = default;
+
+    virtual void SetPenalities(uint16_t P1, uint16_t P2) noexcept = 0;
+
+    virtual void ComputeDisparity(const uint8_t* pLeft, size_t LeftStride, const uint8_t* pRight, size_t RightStride,
+                                  uint16_t* pDisparity, size_t DisparityStride) = 0;
+};
+
+namespace
+{
+template <size_t DMax, size_t DMin, bool UseAVX2>
+class Engine final : public sgm_engine
+{
+    sgm::SemiGlobalMatching<DMax, DMin, UseAVX2> m_sgm;
+
+public:
+    Engine(size_t Width, size_t Height)
+          : sgm_engine(Width, Height)
+          , m_sgm(Width, Height)
+    {
+    }
+
+    void SetPenalities(uint16_t P1, uint16_t P2) noexcept override
+    {
+        m_sgm.SetPenalities(P1, P2);
+    }
+
+    void ComputeDisparity(const uint8_t* pLeft, size_t LeftStride, const uint8_t* pRight, size_t RightStride,
+                          uint16_t* pDisparity, size_t DisparityStride) override
+    {
+        m_sgm.ComputeDisparity(pLeft, LeftStride, pRight, RightStride, pDisparity, DisparityStride);
+    }
+};
+
+constexpr size_t SupportedDMax[] = {16, 32, 48, 64, 96, 128, 192, 256};
+
+template <size_t DMax>
+sgm_engine* MakeEngine(size_t Width, size_t Height)
+{
+    if (sgm_avx2_enabled())
+    {
+        return new Engine<DMax, 0, true>(Width, Height);
+    }
+
+    return new Engine<DMax, 0, false>(Width, Height);
+}
+
+// Must cover every entry of SupportedDMax
+sgm_engine* MakeEngine(size_t Width, size_t Height, size_t DMax)
+{
+    switch (DMax)
+    {
+    case 16:
+        return MakeEngine<16>(Width, Height);
+    case 32:
+        return MakeEngine<32>(Width, Height);
+    case 48:
+        return MakeEngine<48>(Width, Height);
+    case 64:
+        return MakeEngine<64>(Width, Height);
+    case 96:
+        return MakeEngine<96>(Width, Height);
+    case 128:
+        return MakeEngine<128>(Width, Height);
+    case 192:
+        return MakeEngine<192>(Width, Height);
+    case 256:
+        return MakeEngine<256>(Width, Height);
+    default:
+        return nullptr;
+    }
+}
+
+}  // namespace
+
+const char* sgm_status_string(sgm_status status)
+{
+    switch (status)
+    {
+    case SGM_OK:
+        return "Success";
+    case SGM_ERROR_INVALID_ARGUMENT:
+        return "Invalid argument";
+    case SGM_ERROR_UNSUPPORTED_RANGE:
+        return "Unsupported disparity range";
+    case SGM_ERROR_OUT_OF_MEMORY:
+        return "Out of memory";
+    case SGM_ERROR_INTERNAL:
+        return "Internal error";
+    default:
+        return "Unknown status";
+    }
+}
+
+int sgm_is_range_supported(size_t dmin, size_t dmax)
+{
+    if (0 != dmin)
+    {
+        return 0;
+    }
+
+    for (auto d : SupportedDMax)
+    {
+        if (d == dmax)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int sgm_avx2_enabled(void)
+{
+    static const bool Enabled = sgm::instructionset::avx2_supported();
+    return Enabled ? 1 : 0;
+}
+
+sgm_status sgm_engine_create(size_t width, size_t height, size_t dmin, size_t dmax, sgm_engine** engine)
+{
+    if (nullptr == engine)
+    {
+        return SGM_ERROR_INVALID_ARGUMENT;
+    }
+
+    *engine = nullptr;
+
+    if (!sgm_is_range_supported(dmin, dmax))
+    {
+        return SGM_ERROR_UNSUPPORTED_RANGE;
+    }
+
+    // the cost computation assumes that every row spans the whole disparity range
+    if (0 == height || width < dmax)
+    {
+        return SGM_ERROR_INVALID_ARGUMENT;
+    }
+
+    // the cost volumes hold width * height * dmax elements
+    if (width > SIZE_MAX / height / dmax / sizeof(uint16_t))
+    {
+        return SGM_ERROR_INVALID_ARGUMENT;
+    }
+
+    try
+    {
+        *engine = MakeEngine(width, height, dmax);
+        return SGM_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return SGM_ERROR_OUT_OF_MEMORY;
+    }
+    catch (...)
+    {
+        return SGM_ERROR_INTERNAL;
+    }
+}
+
+void sgm_engine_destroy(sgm_engine* engine)
+{
+    delete engine;
+}
+
+sgm_status sgm_engine_set_penalties(sgm_engine* engine, uint16_t p1, uint16_t p2)
+{
+    if (nullptr == engine)
+    {
+        return SGM_ERROR_INVALID_ARGUMENT;
+    }
+
+    engine->SetPenalities(p1, p2);
+    return SGM_OK;
+}
+
+sgm_status sgm_engine_process(sgm_engine* engine, const uint8_t* left, size_t left_stride, const uint8_t* right,
+                              size_t right_stride, uint16_t* disparity, size_t disparity_stride)
+{
+    if (nullptr == engine || nullptr == left || nullptr == right || nullptr == disparity)
+    {
+        return SGM_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (left_stride < engine->Width || right_stride < engine->Width || disparity_stride < engine->Width)
+    {
+        return SGM_ERROR_INVALID_ARGUMENT;
+    }
+
+    try
+    {
+        engine->ComputeDisparity(left, left_stride, right, right_stride, disparity, disparity_stride);
+        return SGM_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return SGM_ERROR_OUT_OF_MEMORY;
+    }
+    catch (...)
+    {
+        return SGM_ERROR_INTERNAL;
+    }
+}
@@ -0,0 +1,124 @@
+#include "test_utils.h"
+#include <sgm/sgm.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+auto static constexpr Width = 300;
+auto static constexpr Height = 120;
+
+template <size_t DMax, bool UseAVX2>
+std::vector<uint16_t> ComputeDisparity(const test::StereoPair& Pair)
+{
+    std::vector<uint16_t> Disparity(Pair.Width * Pair.Height);
+
+    sgm::SemiGlobalMatching<DMax, 0, UseAVX2> Sgm(Pair.Width, Pair.Height);
+    Sgm.SetPenalities(10, 80);
+    Sgm.ComputeDisparity(Pair.Left.data(), Pair.Width, Pair.Right.data(), Pair.Width, Disparity.data(), Pair.Width);
+
+    return Disparity;
+}
+
+template <size_t DMax>
+void CheckAVX2MatchesScalar(const test::StereoPair& Pair)
+{
+    SGM_CHECK((ComputeDisparity<DMax, true>(Pair) == ComputeDisparity<DMax, false>(Pair)));
+}
+
+sgm::SimpleImage ToSimpleImage(const std::vector<uint8_t>& Buffer)
+{
+    sgm::SimpleImage Image{sgm::make_unique_aligned<uint8_t>(Width * Height), Width, Height};
+    std::memcpy(Image.Buffer.get(), Buffer.data(), Width * Height);
+    return Image;
+}
+
+template <bool UseAVX2>
+uint64_t GetDisparityHash(const test::StereoPair& Pair)
+{
+    sgm::SemiGlobalMatching<64, 0, UseAVX2> Sgm(ToSimpleImage(Pair.Left), ToSimpleImage(Pair.Right));
+    Sgm.SetPenalities(10, 80);
+    auto DMap = Sgm.GetDisparity();
+
+    // FNV-1a
+    uint64_t Hash = 14695981039346656037ull;
+    for (size_t i = 0; i < Width * Height; i++)
+    {
+        Hash ^= DMap.Buffer[i];
+        Hash *= 1099511628211ull;
+    }
+
+    return Hash;
+}
+
+template <typename Constructor>
+bool ThrowsInvalidArgument(Constructor&& Construct)
+{
+    try
+    {
+        Construct();
+    }
+    catch (const std::invalid_argument&)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+void CheckInvalidSizes()
+{
+    // rows narrower than the disparity range
+    SGM_CHECK(ThrowsInvalidArgument([] { sgm::SemiGlobalMatching<64, 0, false>(32, 4); }));
+    SGM_CHECK(ThrowsInvalidArgument([] { sgm::SemiGlobalMatching<64, 0, false>(63, 4); }));
+    SGM_CHECK(ThrowsInvalidArgument([] {
+        sgm::SimpleImage Left{sgm::make_unique_aligned<uint8_t>(32 * 4), 32, 4};
+        sgm::SimpleImage Right{sgm::make_unique_aligned<uint8_t>(32 * 4), 32, 4};
+        sgm::SemiGlobalMatching<64, 0, false>(std::move(Left), std::move(Right));
+    }));
+
+    SGM_CHECK(ThrowsInvalidArgument([] { sgm::SemiGlobalMatching<64, 0, false>(64, 0); }));
+
+    // width * height * DInt wraps around size_t
+    const auto Huge = size_t(1) << (sizeof(size_t) * 8 - 2);
+    SGM_CHECK(ThrowsInvalidArgument([Huge] { sgm::SemiGlobalMatching<16, 0, false>(Huge, 8); }));
+
+    SGM_CHECK(!ThrowsInvalidArgument([] { sgm::SemiGlobalMatching<64, 0, false>(64, 1); }));
+}
+
+}  // namespace
+
+int main()
+{
+    CheckInvalidSizes();
+
+    const auto Pair = test::MakeStereoPair(Width, Height);
+
+    // the synthetic shifts are recovered away from the left border
+    auto Disparity = ComputeDisparity<64, false>(Pair);
+    for (size_t iy = 0; iy < Height; iy++)
+    {
+        for (size_t ix = 64; ix < Width; ix++)
+        {
+            SGM_CHECK(Disparity[ix + Width * iy] == (ix < Width / 2 ? 7 : 21));
+        }
+    }
+
+    // normalized output of the scalar kernel before the engine interface was introduced
+    SGM_CHECK(0xd93473faf3081b41ull == GetDisparityHash<false>(Pair));
+
+    if (sgm::instructionset::avx2_supported())
+    {
+        CheckAVX2MatchesScalar<16>(Pair);
+        CheckAVX2MatchesScalar<64>(Pair);
+        CheckAVX2MatchesScalar<256>(Pair);
+        SGM_CHECK(0xd93473faf3081b41ull == GetDisparityHash<true>(Pair));
+    }
+    else
+    {
+        std::cout << "AVX2 not supported, skipping the AVX2 checks" << std::endl;
+    }
+
+    return test::Report("test_sgm");
+}
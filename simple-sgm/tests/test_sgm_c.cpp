@@ -0,0 +1,140 @@
+#include "test_utils.h"
+#include <sgm/sgm.h>
+#include <sgm/sgm_c.h>
+
+#include <cstring>
+
+namespace
+{
+auto static constexpr Width = 300;
+auto static constexpr Height = 120;
+
+std::vector<uint16_t> Process(sgm_engine* Engine, const test::StereoPair& Pair)
+{
+    std::vector<uint16_t> Disparity(Width * Height);
+    SGM_CHECK(SGM_OK
+              == sgm_engine_process(Engine, Pair.Left.data(), Width, Pair.Right.data(), Width, Disparity.data(),
+                                    Width));
+    return Disparity;
+}
+
+void CheckRepeatedProcessing(const test::StereoPair& Pair)
+{
+    sgm_engine* Engine = nullptr;
+    SGM_CHECK(SGM_OK == sgm_engine_create(Width, Height, 0, 64, &Engine));
+    SGM_CHECK(SGM_OK == sgm_engine_set_penalties(Engine, 10, 80));
+
+    auto First = Process(Engine, Pair);
+    auto Second = Process(Engine, Pair);
+    SGM_CHECK(First == Second);
+
+    // the engine must give the result of the kernel it wraps
+    std::vector<uint16_t> Expected(Width * Height);
+    if (sgm_avx2_enabled())
+    {
+        sgm::SemiGlobalMatching<64, 0, true> Sgm(Width, Height);
+        Sgm.SetPenalities(10, 80);
+        Sgm.ComputeDisparity(Pair.Left.data(), Width, Pair.Right.data(), Width, Expected.data(), Width);
+    }
+    else
+    {
+        sgm::SemiGlobalMatching<64, 0, false> Sgm(Width, Height);
+        Sgm.SetPenalities(10, 80);
+        Sgm.ComputeDisparity(Pair.Left.data(), Width, Pair.Right.data(), Width, Expected.data(), Width);
+    }
+    SGM_CHECK(First == Expected);
+
+    sgm_engine_destroy(Engine);
+}
+
+void CheckStridedProcessing(const test::StereoPair& Pair)
+{
+    sgm_engine* Engine = nullptr;
+    SGM_CHECK(SGM_OK == sgm_engine_create(Width, Height, 0, 64, &Engine));
+
+    auto Packed = Process(Engine, Pair);
+
+    const size_t ImageStride = Width + 13;
+    const size_t DisparityStride = Width + 5;
+    std::vector<uint8_t> Left(ImageStride * Height, 0xFF);
+    std::vector<uint8_t> Right(ImageStride * Height, 0xFF);
+    std::vector<uint16_t> Disparity(DisparityStride * Height, 0xFFFF);
+
+    for (size_t iy = 0; iy < Height; iy++)
+    {
+        std::memcpy(&Left[ImageStride * iy], &Pair.Left[Width * iy], Width);
+        std::memcpy(&Right[ImageStride * iy], &Pair.Right[Width * iy], Width);
+    }
+
+    SGM_CHECK(SGM_OK
+              == sgm_engine_process(Engine, Left.data(), ImageStride, Right.data(), ImageStride, Disparity.data(),
+                                    DisparityStride));
+
+    for (size_t iy = 0; iy < Height; iy++)
+    {
+        SGM_CHECK(0 == std::memcmp(&Disparity[DisparityStride * iy], &Packed[Width * iy], Width * sizeof(uint16_t)));
+
+        // padding must be left untouched
+        for (size_t ix = Width; ix < DisparityStride; ix++)
+        {
+            SGM_CHECK(0xFFFF == Disparity[ix + DisparityStride * iy]);
+        }
+    }
+
+    sgm_engine_destroy(Engine);
+}
+
+void CheckInvalidArguments()
+{
+    sgm_engine* Engine = nullptr;
+
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT == sgm_engine_create(Width, Height, 0, 64, nullptr));
+    SGM_CHECK(SGM_ERROR_UNSUPPORTED_RANGE == sgm_engine_create(Width, Height, 16, 64, &Engine));
+    SGM_CHECK(SGM_ERROR_UNSUPPORTED_RANGE == sgm_engine_create(Width, Height, 0, 70, &Engine));
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT == sgm_engine_create(32, Height, 0, 64, &Engine));
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT == sgm_engine_create(Width, 0, 0, 64, &Engine));
+    SGM_CHECK(nullptr == Engine);
+
+    // width * height * dmax wraps around size_t
+    const auto Huge = size_t(1) << (sizeof(size_t) * 8 - 2);
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT == sgm_engine_create(Huge, 8, 0, 16, &Engine));
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT == sgm_engine_create(SIZE_MAX, SIZE_MAX, 0, 16, &Engine));
+    SGM_CHECK(nullptr == Engine);
+
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT == sgm_engine_set_penalties(nullptr, 10, 80));
+
+    SGM_CHECK(SGM_OK == sgm_engine_create(Width, Height, 0, 64, &Engine));
+
+    std::vector<uint8_t> Image(Width * Height);
+    std::vector<uint16_t> Disparity(Width * Height);
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT
+              == sgm_engine_process(nullptr, Image.data(), Width, Image.data(), Width, Disparity.data(), Width));
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT
+              == sgm_engine_process(Engine, nullptr, Width, Image.data(), Width, Disparity.data(), Width));
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT
+              == sgm_engine_process(Engine, Image.data(), Width, Image.data(), Width, nullptr, Width));
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT
+              == sgm_engine_process(Engine, Image.data(), Width - 1, Image.data(), Width, Disparity.data(), Width));
+    SGM_CHECK(SGM_ERROR_INVALID_ARGUMENT
+              == sgm_engine_process(Engine, Image.data(), Width, Image.data(), Width, Disparity.data(), Width - 1));
+
+    sgm_engine_destroy(Engine);
+    sgm_engine_destroy(nullptr);
+}
+
+}  // namespace
+
+int main()
+{
+    const auto Pair = test::MakeStereoPair(Width, Height);
+
+    CheckRepeatedProcessing(Pair);
+    CheckStridedProcessing(Pair);
+    CheckInvalidArguments();
+
+    SGM_CHECK(sgm_is_range_supported(0, 256));
+    SGM_CHECK(!sgm_is_range_supported(0, 512));
+    SGM_CHECK(0 == std::strcmp("Success", sgm_status_string(SGM_OK)));
+
+    return test::Report("test_sgm_c");
+}
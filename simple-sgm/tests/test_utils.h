@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace test
+{
+inline int Failures = 0;
+
+#define SGM_CHECK(condition)                                                                                           \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(condition))                                                                                              \
+        {                                                                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl;                    \
+            ++test::Failures;                                                                                          \
+        }                                                                                                              \
+    } while (false)
+
+struct StereoPair
+{
+    std::vector<uint8_t> Left;
+    std::vector<uint8_t> Right;
+    size_t Width;
+    size_t Height;
+};
+
+/*
+  Random texture seen with a disparity of 7 pixels on the left half of the image and 21 pixels on the right half.
+  A fixed linear congruential generator keeps the images identical on every platform.
+*/
+inline StereoPair MakeStereoPair(size_t Width, size_t Height)
+{
+    StereoPair Pair{std::vector<uint8_t>(Width * Height), std::vector<uint8_t>(Width * Height), Width, Height};
+
+    uint32_t State = 1;
+    for (auto& Pixel : Pair.Right)
+    {
+        State = State * 1103515245u + 12345u;
+        Pixel = static_cast<uint8_t>((State >> 16) & 0xFF);
+    }
+
+    for (size_t iy = 0; iy < Height; iy++)
+    {
+        for (size_t ix = 0; ix < Width; ix++)
+        {
+            auto Shift = ix < Width / 2 ? 7 : 21;
+            Pair.Left[ix + Width * iy] = ix >= Shift ? Pair.Right[ix - Shift + Width * iy] : 0;
+        }
+    }
+
+    return Pair;
+}
+
+inline int Report(const char* Name)
+{
+    if (0 == Failures)
+    {
+        std::cout << Name << ": all checks passed" << std::endl;
+        return 0;
+    }
+
+    std::cerr << Name << ": " << Failures << " check(s) failed" << std::endl;
+    return 1;
+}
+
+}  // namespace test